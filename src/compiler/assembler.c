@@ -1,11 +1,15 @@
 // file: ~/scsa/src/compiler/assembler.c (SCSA: Setting Computer Set Architecture Assembler)
 // Converts SCSA-16 Assembly Mnemonics (e.g., LDA R0, 0xE000) into Machine Code and outputs bootloader.bin.
+// UPGRADE: '--watch' re-assembles only the changed .ORG sections whenever the source is saved.
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 // --- CONSTANTS ---
 #define RAM_SIZE 0x10000 // 64 KB
@@ -48,6 +52,18 @@ uint16_t parse_operand(char *op_str) {
 uint8_t machine_code_buffer[RAM_SIZE];
 int program_counter = START_PC;
 int current_offset = 0; // Tracks the current offset within the machine_code_buffer
+int emit_low = RAM_SIZE, emit_high = 0; // Range of bytes written since the last reset_emit_range()
+
+void reset_emit_range() {
+    emit_low = RAM_SIZE;
+    emit_high = 0;
+}
+
+void emit_byte(uint8_t value) {
+    if (current_offset < emit_low) emit_low = current_offset;
+    if (current_offset + 1 > emit_high) emit_high = current_offset + 1;
+    machine_code_buffer[current_offset++] = value;
+}
 
 void assemble_line(char *line) {
     char *tokens[4];
@@ -71,8 +87,8 @@ void assemble_line(char *line) {
         // Handle .WORD directive (for data)
         if (strcasecmp(tokens[0], ".WORD") == 0 && token_count > 1) {
             uint16_t data = parse_operand(tokens[1]);
-            machine_code_buffer[current_offset++] = (uint8_t)(data >> 8); // High Byte
-            machine_code_buffer[current_offset++] = (uint8_t)(data & 0xFF);  // Low Byte
+            emit_byte((uint8_t)(data >> 8)); // High Byte
+            emit_byte((uint8_t)(data & 0xFF));  // Low Byte
         }
         return;
     }
@@ -88,8 +104,8 @@ void assemble_line(char *line) {
     int bytes_written = 3;
 
     if (instr->operand_count > 0) {
-        // Check for Register and Operand
-        uint8_t reg_id = get_register_id(tokens[1]);
+        // Check for Register and Operand (JMP ADDR has no register)
+        uint8_t reg_id = (instr->operand_count == 2) ? get_register_id(tokens[1]) : 0x0;
         if (reg_id == 0xFF) { fprintf(stderr, "[ERROR] Invalid Register: %s\n", tokens[1]); return; }
         
         byte1 = (instr->opcode << 4) | reg_id;
@@ -104,9 +120,9 @@ void assemble_line(char *line) {
     }
     
     // Write to buffer
-    machine_code_buffer[current_offset++] = byte1;
-    machine_code_buffer[current_offset++] = (uint8_t)(operand >> 8); 
-    machine_code_buffer[current_offset++] = (uint8_t)(operand & 0xFF);
+    emit_byte(byte1);
+    emit_byte((uint8_t)(operand >> 8)); 
+    emit_byte((uint8_t)(operand & 0xFF));
     
     printf("[ASM] %04X: %s -> %02X %02X %02X\n", 
            program_counter, tokens[0], byte1, (uint8_t)(operand >> 8), (uint8_t)(operand & 0xFF));
@@ -114,50 +130,231 @@ void assemble_line(char *line) {
     program_counter += bytes_written;
 }
 
-void assemble_file(const char *filename) {
+// --- Source Sections ---
+// A section is a run of source lines starting at a .ORG directive (or the top of the file).
+// Every section sets its own address, so it assembles independently of the others: after
+// an edit only the sections whose text changed have to be re-assembled. Overlapping
+// sections are the exception: later ones overwrite earlier ones, so any overlap falls
+// back to assembling every section in order.
+#define MAX_SECTIONS 256
+
+typedef struct {
+    char *text;      // Raw section source (lines joined with '\n')
+    int low, high;   // Bytes written by this section: [low, high)
+    int end_offset;  // current_offset after the section's last line
+} Section;
+
+Section sections[MAX_SECTIONS];
+int section_count = 0;
+
+// Must accept exactly the lines assemble_file()/assemble_line() act on as .ORG:
+// unindented, not a comment, first token ".ORG" and an operand present.
+int is_org_line(const char *line) {
+    char copy[256];
+    if (line[0] == ';' || line[0] == '\0' || isspace((unsigned char)line[0])) return 0;
+    snprintf(copy, sizeof(copy), "%s", line);
+    copy[strcspn(copy, "\n")] = 0;
+    char *directive = strtok(copy, " \t,");
+    char *operand = strtok(NULL, " \t,");
+    return directive != NULL && strcasecmp(directive, ".ORG") == 0 && operand != NULL && operand[0] != ';';
+}
+
+// Splits the source file into sections. Returns the count, or -1 on error.
+int read_sections(const char *filename, Section *out) {
     FILE *file = fopen(filename, "r");
     if (file == NULL) {
         perror("Error opening assembly file");
-        return;
+        return -1;
     }
-    
     char line[256];
+    int count = 0;
+    size_t len = 0;
+    out[0].text = NULL;
+    while (fgets(line, sizeof(line), file)) {
+        if (is_org_line(line) && len > 0) {
+            if (count + 1 >= MAX_SECTIONS) {
+                fprintf(stderr, "Error: %s has more than %d .ORG sections\n", filename, MAX_SECTIONS);
+                for (int i = 0; i <= count; i++) free(out[i].text);
+                fclose(file);
+                return -1;
+            }
+            count++;
+            out[count].text = NULL;
+            len = 0;
+        }
+        size_t n = strlen(line);
+        out[count].text = realloc(out[count].text, len + n + 1);
+        memcpy(out[count].text + len, line, n + 1);
+        len += n;
+    }
+    fclose(file);
+    if (out[0].text == NULL) out[0].text = strdup("");
+    return count + 1;
+}
+
+void assemble_section(Section *section) {
+    char *text = strdup(section->text);
     program_counter = START_PC; 
     current_offset = START_PC;
-    memset(machine_code_buffer, 0, RAM_SIZE);
-
-    printf("\n--- SCSA-16 Assembler Start ---\n");
+    reset_emit_range();
 
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\n")] = 0; 
+    for (char *line = text, *next; line != NULL && *line != '\0'; line = next) {
+        next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
         char line_copy[256];
-        strcpy(line_copy, line);
+        snprintf(line_copy, sizeof(line_copy), "%s", line);
         
         if (line_copy[0] == ';' || line_copy[0] == '\0' || isspace(line_copy[0])) continue;
 
         assemble_line(line_copy);
     }
-    
-    fclose(file);
-    printf("--- SCSA-16 Assembler Complete. Size: %d Bytes ---\n", current_offset);
+    free(text);
+    section->low = emit_low;
+    section->high = emit_high;
+    section->end_offset = current_offset;
+}
 
-    // --- Write the Machine Code to bootloader.bin ---
-    FILE *out_file = fopen("bootloader.bin", "wb");
+// The VM loads bootloader.bin at START_PC, so the image starts there and runs up to the last offset
+int image_size(int end_offset) {
+    return end_offset > START_PC ? end_offset - START_PC : 0;
+}
+
+int write_output(int end_offset) {
+    // Write to a temporary file and rename it, so a watching VM never sees a partial image
+    FILE *out_file = fopen("bootloader.bin.tmp", "wb");
     if (out_file == NULL) {
         perror("Error creating bootloader.bin");
-        return;
+        return 0;
     }
-    // Write only the portion of RAM that contains the program/data (up to current_offset)
-    fwrite(machine_code_buffer, 1, current_offset, out_file);
+    int size = image_size(end_offset);
+    fwrite(&machine_code_buffer[START_PC], 1, size, out_file);
     fclose(out_file);
+    if (rename("bootloader.bin.tmp", "bootloader.bin") != 0) {
+        perror("Error creating bootloader.bin");
+        return 0;
+    }
+    return 1;
+}
+
+int assemble_file(const char *filename) {
+    memset(machine_code_buffer, 0, RAM_SIZE);
+    section_count = read_sections(filename, sections);
+    if (section_count < 0) {
+        section_count = 0;
+        return 0;
+    }
+
+    printf("\n--- SCSA-16 Assembler Start ---\n");
+    for (int i = 0; i < section_count; i++) assemble_section(&sections[i]);
+    int end_offset = sections[section_count - 1].end_offset;
+    printf("--- SCSA-16 Assembler Complete. Size: %d Bytes ---\n", image_size(end_offset));
+
+    // --- Write the Machine Code to bootloader.bin ---
+    if (!write_output(end_offset)) return 0;
     printf("[OUTPUT] Successfully wrote machine code to: bootloader.bin\n");
+    return 1;
+}
+
+int ranges_overlap(const Section *a, const Section *b) {
+    return a->low < a->high && b->low < b->high && a->low < b->high && b->low < a->high;
+}
+
+// Re-assembles only the sections whose text changed since the last assembly.
+void reassemble_changed(const char *filename) {
+    static Section fresh[MAX_SECTIONS];
+    static int reused[MAX_SECTIONS];
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    int fresh_count = read_sections(filename, fresh);
+    if (fresh_count < 0) return;
+    memset(reused, 0, sizeof(reused));
+
+    // 1. Keep the output of sections whose text is unchanged (matched anywhere in the file)
+    int changed = 0;
+    for (int i = 0; i < fresh_count; i++) {
+        fresh[i].low = -1;
+        for (int j = 0; j < section_count; j++) {
+            if (!reused[j] && strcmp(fresh[i].text, sections[j].text) == 0) {
+                reused[j] = 1;
+                fresh[i].low = sections[j].low;
+                fresh[i].high = sections[j].high;
+                fresh[i].end_offset = sections[j].end_offset;
+                break;
+            }
+        }
+        if (fresh[i].low < 0) changed++;
+    }
+
+    // 2. Clear the bytes of sections that were edited or removed
+    int overlaps = 0;
+    for (int j = 0; j < section_count; j++) {
+        if (reused[j] || sections[j].high <= sections[j].low) continue;
+        memset(&machine_code_buffer[sections[j].low], 0, sections[j].high - sections[j].low);
+        for (int i = 0; i < fresh_count; i++) {
+            if (fresh[i].low >= 0 && ranges_overlap(&fresh[i], &sections[j])) overlaps = 1;
+        }
+    }
+
+    // 3. Assemble the edited sections
+    for (int i = 0; i < fresh_count; i++) {
+        if (fresh[i].low < 0) assemble_section(&fresh[i]);
+    }
+
+    // 4. Overlapping sections: which bytes win depends on source order, so fall back
+    // to assembling every section in order, exactly as assemble_file() would
+    for (int i = 0; i < fresh_count && !overlaps; i++) {
+        for (int k = i + 1; k < fresh_count; k++) {
+            if (ranges_overlap(&fresh[i], &fresh[k])) overlaps = 1;
+        }
+    }
+    if (overlaps) {
+        memset(machine_code_buffer, 0, RAM_SIZE);
+        for (int i = 0; i < fresh_count; i++) assemble_section(&fresh[i]);
+        changed = fresh_count;
+    }
+
+    for (int j = 0; j < section_count; j++) free(sections[j].text);
+    memcpy(sections, fresh, fresh_count * sizeof(Section));
+    section_count = fresh_count;
+
+    int end_offset = sections[section_count - 1].end_offset;
+    write_output(end_offset);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("[WATCH] Re-assembled %d of %d sections in %.2f ms. Size: %d Bytes\n", changed, section_count,
+           (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6, image_size(end_offset));
+    fflush(stdout);
+}
+
+// --- Watch Mode: re-assemble on every save ---
+#define WATCH_POLL_US 20000 // 20 ms
+
+void watch_file(const char *filename) {
+    struct stat st;
+    struct timespec last_mtime = { 0, 0 };
+    off_t last_size = -1;
+    if (stat(filename, &st) == 0) { last_mtime = st.st_mtim; last_size = st.st_size; }
+    printf("[WATCH] Watching %s (Ctrl-C to stop)...\n", filename);
+
+    while (1) {
+        usleep(WATCH_POLL_US);
+        if (stat(filename, &st) != 0) continue;
+        if (st.st_mtim.tv_sec == last_mtime.tv_sec && st.st_mtim.tv_nsec == last_mtime.tv_nsec &&
+            st.st_size == last_size) continue;
+        last_mtime = st.st_mtim;
+        last_size = st.st_size;
+        reassemble_changed(filename);
+    }
 }
 
 int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <assembly_file.asm>\n", argv[0]);
+    int watch = (argc > 2 && strcmp(argv[1], "--watch") == 0);
+    if (argc < 2 || (strcmp(argv[1], "--watch") == 0 && !watch)) {
+        fprintf(stderr, "Usage: %s [--watch] <assembly_file.asm>\n", argv[0]);
         return 1;
     }
-    assemble_file(argv[1]);
-    return 0;
+    const char *filename = argv[watch ? 2 : 1];
+    int ok = assemble_file(filename);
+    if (watch) watch_file(filename);
+    return ok ? 0 : 1;
 }
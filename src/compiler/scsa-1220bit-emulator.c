@@ -4,7 +4,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
 #include <unistd.h> 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCSA_X86_SIMD 1
+#endif
 
 // HARDWARE CONSTANTS
 #define WORD_SIZE_BITS 1220
@@ -16,8 +22,373 @@ typedef struct {
     uint64_t seg[NUM_SEGMENTS]; // Array to hold the massive 1220-bit register
 } Reg1220;
 
-Reg1220 PC_1220; // 1220-bit Program Counter
-Reg1220 R_ACC;   // 1220-bit Accumulator
+#define CACHE_LINE_BYTES 64
+Reg1220 PC_1220 __attribute__((aligned(CACHE_LINE_BYTES))); // 1220-bit Program Counter
+Reg1220 R_ACC __attribute__((aligned(CACHE_LINE_BYTES)));   // 1220-bit Accumulator
+
+// --- 1220-bit ALU Logic Kernels ---
+// Bitwise, shift/rotate, bit-count and compare operations on the 1220-bit word.
+// Bits 1220..1279 of the top segment are register-only (the Security Tag lives there):
+// CMP/POPCOUNT/CLZ/CTZ ignore them, and shifts/rotates neither read nor write them
+// (ROL/ROR wrap at bit 1220). The lane-wise AND/OR/XOR/NOT apply to them like any other
+// bit; the packed memory store drops them. Each kernel exists as a portable scalar
+// version and, on x86, as AVX2 and AVX-512 versions. The kernel sets are static tables;
+// reg1220_ops_init() takes the widest one the host supports (AVX-512, else AVX2, else scalar).
+#define REG1220_TOP (NUM_SEGMENTS - 1)
+#define REG1220_TOP_MASK ((1ULL << (WORD_SIZE_BITS % 64)) - 1)  // Word bits in seg[REG1220_TOP]
+#define REG1220_PAD_BITS (NUM_SEGMENTS * 64 - WORD_SIZE_BITS)  // 60
+
+typedef struct {
+    const char *name;
+    void (*and_op)(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b);
+    void (*or_op)(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b);
+    void (*xor_op)(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b);
+    void (*not_op)(Reg1220 *dst, const Reg1220 *a);
+    // Funnel shift: dst[i] = (src[base+i] << r) | (src[base+i-1] >> (64-r)), r in 0..63.
+    // All shifts and rotates reduce to this over a padded copy of the source.
+    void (*funnel_op)(Reg1220 *dst, const uint64_t *src, int base, unsigned r);
+    int (*cmp_op)(const Reg1220 *a, const Reg1220 *b); // Unsigned: -1, 0, 1
+    unsigned (*popcount_op)(const Reg1220 *a);
+    unsigned (*clz_op)(const Reg1220 *a);              // WORD_SIZE_BITS if zero
+    unsigned (*ctz_op)(const Reg1220 *a);              // WORD_SIZE_BITS if zero
+} Reg1220Ops;
+
+// Scalar fallback (any CPU)
+static void and_scalar(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b) {
+    for (int i = 0; i < NUM_SEGMENTS; i++) dst->seg[i] = a->seg[i] & b->seg[i];
+}
+static void or_scalar(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b) {
+    for (int i = 0; i < NUM_SEGMENTS; i++) dst->seg[i] = a->seg[i] | b->seg[i];
+}
+static void xor_scalar(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b) {
+    for (int i = 0; i < NUM_SEGMENTS; i++) dst->seg[i] = a->seg[i] ^ b->seg[i];
+}
+static void not_scalar(Reg1220 *dst, const Reg1220 *a) {
+    for (int i = 0; i < NUM_SEGMENTS; i++) dst->seg[i] = ~a->seg[i];
+}
+static void funnel_scalar(Reg1220 *dst, const uint64_t *src, int base, unsigned r) {
+    for (int i = 0; i < NUM_SEGMENTS; i++) {
+        uint64_t hi = src[base + i], lo = src[base + i - 1];
+        dst->seg[i] = r ? (hi << r) | (lo >> (64 - r)) : hi;
+    }
+}
+static int cmp_scalar(const Reg1220 *a, const Reg1220 *b) {
+    uint64_t top_a = a->seg[REG1220_TOP] & REG1220_TOP_MASK, top_b = b->seg[REG1220_TOP] & REG1220_TOP_MASK;
+    if (top_a != top_b) return top_a > top_b ? 1 : -1;
+    for (int i = REG1220_TOP - 1; i >= 0; i--) {
+        if (a->seg[i] != b->seg[i]) return a->seg[i] > b->seg[i] ? 1 : -1;
+    }
+    return 0;
+}
+static unsigned popcount_scalar(const Reg1220 *a) {
+    unsigned count = 0;
+    for (int i = 0; i < REG1220_TOP; i++) count += __builtin_popcountll(a->seg[i]);
+    return count + __builtin_popcountll(a->seg[REG1220_TOP] & REG1220_TOP_MASK);
+}
+static unsigned clz_scalar(const Reg1220 *a) {
+    uint64_t top = a->seg[REG1220_TOP] & REG1220_TOP_MASK;
+    if (top) return __builtin_clzll(top) - REG1220_PAD_BITS;
+    for (int i = REG1220_TOP - 1; i >= 0; i--) {
+        if (a->seg[i]) return (REG1220_TOP - i) * 64 - REG1220_PAD_BITS + __builtin_clzll(a->seg[i]);
+    }
+    return WORD_SIZE_BITS;
+}
+static unsigned ctz_scalar(const Reg1220 *a) {
+    for (int i = 0; i < REG1220_TOP; i++) {
+        if (a->seg[i]) return i * 64 + __builtin_ctzll(a->seg[i]);
+    }
+    uint64_t top = a->seg[REG1220_TOP] & REG1220_TOP_MASK;
+    return top ? REG1220_TOP * 64 + __builtin_ctzll(top) : WORD_SIZE_BITS;
+}
+
+static const Reg1220Ops REG1220_OPS_SCALAR = {
+    "scalar", and_scalar, or_scalar, xor_scalar, not_scalar, funnel_scalar,
+    cmp_scalar, popcount_scalar, clz_scalar, ctz_scalar
+};
+
+#ifdef SCSA_X86_SIMD
+// AVX2: 20 segments = 5 x 256-bit lanes, fully unrolled.
+#define AVX2_LANES (NUM_SEGMENTS / 4)
+#define AVX2_BINARY_OP(fn, intrin) \
+    __attribute__((target("avx2"))) \
+    static void fn(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b) { \
+        for (int i = 0; i < AVX2_LANES; i++) { \
+            __m256i va = _mm256_loadu_si256((const __m256i *)&a->seg[i * 4]); \
+            __m256i vb = _mm256_loadu_si256((const __m256i *)&b->seg[i * 4]); \
+            _mm256_storeu_si256((__m256i *)&dst->seg[i * 4], intrin(va, vb)); \
+        } \
+    }
+AVX2_BINARY_OP(and_avx2, _mm256_and_si256)
+AVX2_BINARY_OP(or_avx2, _mm256_or_si256)
+AVX2_BINARY_OP(xor_avx2, _mm256_xor_si256)
+
+__attribute__((target("avx2")))
+static void not_avx2(Reg1220 *dst, const Reg1220 *a) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    for (int i = 0; i < AVX2_LANES; i++) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)&a->seg[i * 4]);
+        _mm256_storeu_si256((__m256i *)&dst->seg[i * 4], _mm256_xor_si256(va, ones));
+    }
+}
+
+__attribute__((target("avx2")))
+static void funnel_avx2(Reg1220 *dst, const uint64_t *src, int base, unsigned r) {
+    // A shift count of 64 yields 0 in vpsrlq, so r == 0 needs no special case.
+    const __m128i left = _mm_cvtsi32_si128(r), right = _mm_cvtsi32_si128(64 - r);
+    for (int i = 0; i < AVX2_LANES; i++) {
+        __m256i hi = _mm256_loadu_si256((const __m256i *)&src[base + i * 4]);
+        __m256i lo = _mm256_loadu_si256((const __m256i *)&src[base + i * 4 - 1]);
+        __m256i v = _mm256_or_si256(_mm256_sll_epi64(hi, left), _mm256_srl_epi64(lo, right));
+        _mm256_storeu_si256((__m256i *)&dst->seg[i * 4], v);
+    }
+}
+
+// Builds a 20-bit mask (bit i = segment i) of segments where a == b.
+__attribute__((target("avx2")))
+static uint32_t eq_mask_avx2(const Reg1220 *a, const Reg1220 *b) {
+    uint32_t mask = 0;
+    for (int i = 0; i < AVX2_LANES; i++) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)&a->seg[i * 4]);
+        __m256i vb = _mm256_loadu_si256((const __m256i *)&b->seg[i * 4]);
+        mask |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(va, vb))) << (i * 4);
+    }
+    return mask;
+}
+
+// Same as above against zero: bit i set when segment i is zero.
+__attribute__((target("avx2")))
+static uint32_t zero_mask_avx2(const Reg1220 *a) {
+    uint32_t mask = 0;
+    const __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < AVX2_LANES; i++) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)&a->seg[i * 4]);
+        mask |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(va, zero))) << (i * 4);
+    }
+    return mask;
+}
+
+#define SEG_MASK_ALL ((1u << NUM_SEGMENTS) - 1)
+#define SEG_MASK_TOP (1u << REG1220_TOP)
+
+// Segment masks see the whole top segment; these keep only its word bits.
+static inline uint32_t diff_mask_word(uint32_t diff, const Reg1220 *a, const Reg1220 *b) {
+    if (((a->seg[REG1220_TOP] ^ b->seg[REG1220_TOP]) & REG1220_TOP_MASK) == 0) diff &= ~SEG_MASK_TOP;
+    return diff;
+}
+static inline uint32_t nonzero_mask_word(uint32_t nonzero, const Reg1220 *a) {
+    if ((a->seg[REG1220_TOP] & REG1220_TOP_MASK) == 0) nonzero &= ~SEG_MASK_TOP;
+    return nonzero;
+}
+static inline uint64_t word_seg(const Reg1220 *a, int i) {
+    return i == REG1220_TOP ? a->seg[i] & REG1220_TOP_MASK : a->seg[i];
+}
+
+__attribute__((target("avx2")))
+static int cmp_avx2(const Reg1220 *a, const Reg1220 *b) {
+    uint32_t diff = diff_mask_word(~eq_mask_avx2(a, b) & SEG_MASK_ALL, a, b);
+    if (!diff) return 0;
+    int i = 31 - __builtin_clz(diff); // Most significant differing segment
+    return word_seg(a, i) > word_seg(b, i) ? 1 : -1;
+}
+
+__attribute__((target("popcnt")))
+static unsigned popcount_hw(const Reg1220 *a) {
+    unsigned count = 0;
+    for (int i = 0; i < REG1220_TOP; i++) count += (unsigned)_mm_popcnt_u64(a->seg[i]);
+    return count + (unsigned)_mm_popcnt_u64(a->seg[REG1220_TOP] & REG1220_TOP_MASK);
+}
+
+__attribute__((target("avx2")))
+static unsigned clz_avx2(const Reg1220 *a) {
+    uint32_t nonzero = nonzero_mask_word(~zero_mask_avx2(a) & SEG_MASK_ALL, a);
+    if (!nonzero) return WORD_SIZE_BITS;
+    int i = 31 - __builtin_clz(nonzero);
+    return (REG1220_TOP - i) * 64 - REG1220_PAD_BITS + (unsigned)__builtin_clzll(word_seg(a, i));
+}
+
+__attribute__((target("avx2")))
+static unsigned ctz_avx2(const Reg1220 *a) {
+    uint32_t nonzero = nonzero_mask_word(~zero_mask_avx2(a) & SEG_MASK_ALL, a);
+    if (!nonzero) return WORD_SIZE_BITS;
+    int i = __builtin_ctz(nonzero);
+    return i * 64 + (unsigned)__builtin_ctzll(word_seg(a, i));
+}
+
+static const Reg1220Ops REG1220_OPS_AVX2 = {
+    "avx2", and_avx2, or_avx2, xor_avx2, not_avx2, funnel_avx2,
+    cmp_avx2, popcount_hw, clz_avx2, ctz_avx2
+};
+
+// AVX-512: 20 segments = 2 full 512-bit lanes + 1 masked half lane (4 segments).
+#define AVX512_TAIL_MASK ((__mmask8)0x0F)
+#define AVX512_BINARY_OP(fn, intrin) \
+    __attribute__((target("avx512f"))) \
+    static void fn(Reg1220 *dst, const Reg1220 *a, const Reg1220 *b) { \
+        for (int i = 0; i < 16; i += 8) { \
+            __m512i va = _mm512_loadu_si512(&a->seg[i]); \
+            __m512i vb = _mm512_loadu_si512(&b->seg[i]); \
+            _mm512_storeu_si512(&dst->seg[i], intrin(va, vb)); \
+        } \
+        __m512i va = _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &a->seg[16]); \
+        __m512i vb = _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &b->seg[16]); \
+        _mm512_mask_storeu_epi64(&dst->seg[16], AVX512_TAIL_MASK, intrin(va, vb)); \
+    }
+AVX512_BINARY_OP(and_avx512, _mm512_and_si512)
+AVX512_BINARY_OP(or_avx512, _mm512_or_si512)
+AVX512_BINARY_OP(xor_avx512, _mm512_xor_si512)
+
+__attribute__((target("avx512f")))
+static void not_avx512(Reg1220 *dst, const Reg1220 *a) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    for (int i = 0; i < 16; i += 8) {
+        __m512i va = _mm512_loadu_si512(&a->seg[i]);
+        _mm512_storeu_si512(&dst->seg[i], _mm512_xor_si512(va, ones));
+    }
+    __m512i va = _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &a->seg[16]);
+    _mm512_mask_storeu_epi64(&dst->seg[16], AVX512_TAIL_MASK, _mm512_xor_si512(va, ones));
+}
+
+__attribute__((target("avx512f")))
+static void funnel_avx512(Reg1220 *dst, const uint64_t *src, int base, unsigned r) {
+    const __m128i left = _mm_cvtsi32_si128(r), right = _mm_cvtsi32_si128(64 - r);
+    for (int i = 0; i < 16; i += 8) {
+        __m512i hi = _mm512_loadu_si512(&src[base + i]);
+        __m512i lo = _mm512_loadu_si512(&src[base + i - 1]);
+        _mm512_storeu_si512(&dst->seg[i], _mm512_or_si512(_mm512_sll_epi64(hi, left), _mm512_srl_epi64(lo, right)));
+    }
+    __m512i hi = _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &src[base + 16]);
+    __m512i lo = _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &src[base + 15]);
+    _mm512_mask_storeu_epi64(&dst->seg[16], AVX512_TAIL_MASK,
+                             _mm512_or_si512(_mm512_sll_epi64(hi, left), _mm512_srl_epi64(lo, right)));
+}
+
+__attribute__((target("avx512f")))
+static int cmp_avx512(const Reg1220 *a, const Reg1220 *b) {
+    uint32_t diff = 0;
+    for (int i = 0; i < 16; i += 8) {
+        diff |= (uint32_t)_mm512_cmpneq_epu64_mask(_mm512_loadu_si512(&a->seg[i]), _mm512_loadu_si512(&b->seg[i])) << i;
+    }
+    diff |= (uint32_t)_mm512_mask_cmpneq_epu64_mask(AVX512_TAIL_MASK,
+                _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &a->seg[16]),
+                _mm512_maskz_loadu_epi64(AVX512_TAIL_MASK, &b->seg[16])) << 16;
+    diff = diff_mask_word(diff, a, b);
+    if (!diff) return 0;
+    int i = 31 - __builtin_clz(diff);
+    return word_seg(a, i) > word_seg(b, i) ? 1 : -1;
+}
+
+static const Reg1220Ops REG1220_OPS_AVX512 = {
+    "avx512", and_avx512, or_avx512, xor_avx512, not_avx512, funnel_avx512,
+    cmp_avx512, popcount_hw, clz_avx2, ctz_avx2
+};
+#endif // SCSA_X86_SIMD
+
+// Kernel set for this host, chosen by reg1220_ops_init()
+const Reg1220Ops *REG1220_OPS = &REG1220_OPS_SCALAR;
+
+#ifdef SCSA_X86_SIMD
+// Both vector sets use the POPCNT kernel; the AVX-512 set also reuses the AVX2 CLZ/CTZ.
+static int cpu_supports_set(const char *isa) {
+    if (!__builtin_cpu_supports("popcnt") || !__builtin_cpu_supports("avx2")) return 0;
+    return strcmp(isa, "avx512f") != 0 || __builtin_cpu_supports("avx512f");
+}
+#endif
+
+void reg1220_ops_init() {
+#ifdef SCSA_X86_SIMD
+    __builtin_cpu_init();
+    if (cpu_supports_set("avx512f")) REG1220_OPS = &REG1220_OPS_AVX512;
+    else if (cpu_supports_set("avx2")) REG1220_OPS = &REG1220_OPS_AVX2;
+#endif
+}
+
+// Shifts and rotates: stage the source in a padded window so every output segment
+// is a funnel of two neighbouring inputs (no per-segment bounds checks). Only the
+// 1220 word bits enter the window and only they survive in the result.
+#define SHIFT_WINDOW (NUM_SEGMENTS * 3)
+
+void reg1220_shl(Reg1220 *dst, const Reg1220 *a, unsigned n) {
+    uint64_t window[SHIFT_WINDOW] = { 0 }; // [0..19] = 0, [20..39] = a
+    if (n >= WORD_SIZE_BITS) { memset(dst, 0, sizeof(*dst)); return; }
+    memcpy(&window[NUM_SEGMENTS], a->seg, sizeof(a->seg));
+    REG1220_OPS->funnel_op(dst, window, NUM_SEGMENTS - n / 64, n % 64);
+    dst->seg[REG1220_TOP] &= REG1220_TOP_MASK;
+}
+
+void reg1220_shr(Reg1220 *dst, const Reg1220 *a, unsigned n) {
+    uint64_t window[SHIFT_WINDOW] = { 0 }; // [1..20] = a, rest = 0
+    if (n >= WORD_SIZE_BITS) { memset(dst, 0, sizeof(*dst)); return; }
+    memcpy(&window[1], a->seg, sizeof(a->seg));
+    window[1 + REG1220_TOP] &= REG1220_TOP_MASK;
+    unsigned q = n / 64, r = n % 64;
+    // A right shift by r is a left funnel by (64 - r) one segment further up.
+    if (r == 0) REG1220_OPS->funnel_op(dst, window, 1 + q, 0);
+    else REG1220_OPS->funnel_op(dst, window, 2 + q, 64 - r);
+}
+
+// 1220 is not a multiple of 64, so a rotate is the OR of the two shifted halves.
+void reg1220_rol(Reg1220 *dst, const Reg1220 *a, unsigned n) {
+    Reg1220 hi, lo;
+    n %= WORD_SIZE_BITS;
+    reg1220_shl(&hi, a, n);
+    reg1220_shr(&lo, a, WORD_SIZE_BITS - n); // n == 0 shifts everything out
+    REG1220_OPS->or_op(dst, &hi, &lo);
+}
+
+void reg1220_ror(Reg1220 *dst, const Reg1220 *a, unsigned n) {
+    reg1220_rol(dst, a, WORD_SIZE_BITS - n % WORD_SIZE_BITS);
+}
+
+// --- Packed 1220-bit Memory ---
+// Guest memory does not store Reg1220 (160 bytes per word). A word is 19 full segments
+// (1216 bits) plus a 4-bit tail, i.e. exactly 152.5 bytes. Words are grouped in blocks of
+// MEM1220_BLOCK_WORDS: the 19-segment bodies back to back, then one cache line holding
+// all the 4-bit tails. Each block is 305 whole cache lines with no padding.
+// Words unpack into Reg1220 only at the ALU boundary (mem1220_load / mem1220_store).
+// Bits above 1219 (the register-only Security Tag area) read back as zero.
+#define MEM1220_BODY_SEGMENTS (WORD_SIZE_BITS / 64)                  // 19
+#define MEM1220_TAIL_BITS (WORD_SIZE_BITS - MEM1220_BODY_SEGMENTS * 64) // 4
+#define MEM1220_BLOCK_WORDS (CACHE_LINE_BYTES * 8 / MEM1220_TAIL_BITS)   // 128
+
+typedef struct {
+    uint64_t body[MEM1220_BLOCK_WORDS][MEM1220_BODY_SEGMENTS];
+    uint8_t tails[CACHE_LINE_BYTES]; // Two 4-bit tails per byte
+} __attribute__((aligned(CACHE_LINE_BYTES))) Mem1220Block;
+
+typedef struct {
+    Mem1220Block *blocks;
+    size_t num_words;
+} Mem1220;
+
+int mem1220_init(Mem1220 *mem, size_t num_words) {
+    size_t num_blocks = (num_words + MEM1220_BLOCK_WORDS - 1) / MEM1220_BLOCK_WORDS;
+    mem->blocks = aligned_alloc(CACHE_LINE_BYTES, num_blocks * sizeof(Mem1220Block));
+    if (mem->blocks == NULL) return 0;
+    memset(mem->blocks, 0, num_blocks * sizeof(Mem1220Block));
+    mem->num_words = num_words;
+    return 1;
+}
+
+void mem1220_free(Mem1220 *mem) {
+    free(mem->blocks);
+    mem->blocks = NULL;
+    mem->num_words = 0;
+}
+
+static inline void mem1220_load(Reg1220 *dst, const Mem1220 *mem, size_t addr) {
+    const Mem1220Block *block = &mem->blocks[addr / MEM1220_BLOCK_WORDS];
+    size_t slot = addr % MEM1220_BLOCK_WORDS;
+    memcpy(dst->seg, block->body[slot], sizeof(block->body[slot]));
+    dst->seg[NUM_SEGMENTS - 1] = (block->tails[slot / 2] >> ((slot & 1) * 4)) & 0xF;
+}
+
+static inline void mem1220_store(Mem1220 *mem, size_t addr, const Reg1220 *src) {
+    Mem1220Block *block = &mem->blocks[addr / MEM1220_BLOCK_WORDS];
+    size_t slot = addr % MEM1220_BLOCK_WORDS;
+    unsigned shift = (slot & 1) * 4;
+    memcpy(block->body[slot], src->seg, sizeof(block->body[slot]));
+    block->tails[slot / 2] = (block->tails[slot / 2] & ~(0xF << shift)) | ((src->seg[MEM1220_BODY_SEGMENTS] & 0xF) << shift);
+}
 
 // --- PSI/O 1220-bit Core Services ---
 void execute_service_1220(int service_id) {
@@ -25,6 +396,7 @@ void execute_service_1220(int service_id) {
     switch (service_id) {
         case 1: // Hyper-Scale Diagnostics
             // Check the Security Tag (simulated in the highest effective segment)
+            // The tag fits in one segment: a single 64-bit compare, no 20-segment kernel needed
             if (PC_1220.seg[NUM_SEGMENTS - 1] == SECURITY_TAG_1220) {
                  printf("1220-bit Security Tag Verified OK. System Integrity Confirmed.\n");
             } else {
@@ -41,14 +413,128 @@ void execute_service_1220(int service_id) {
 }
 
 
-int main() {
+// --- ALU Kernel Benchmark (scsa-1220bit-emulator --bench) ---
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define BENCH_ITERATIONS 10000000L
+#define BENCH_RUN(label, stmt) do { \
+        double t0 = now_ns(); \
+        for (long it = 0; it < BENCH_ITERATIONS; it++) { stmt; __asm__ volatile("" ::: "memory"); } \
+        double ns = (now_ns() - t0) / BENCH_ITERATIONS; \
+        printf("  %-10s %7.2f ns/op  %8.1f Mops/s\n", label, ns, 1e3 / ns); \
+    } while (0)
+
+void run_alu_benchmark(const Reg1220Ops *ops) {
+    Reg1220 a, b, d;
+    volatile unsigned sink = 0;
+    for (int i = 0; i < NUM_SEGMENTS; i++) {
+        a.seg[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+        b.seg[i] = 0xC2B2AE3D27D4EB4FULL * (i + 7);
+    }
+    const Reg1220Ops *saved = REG1220_OPS;
+    REG1220_OPS = ops;
+    printf("[BENCH] Kernel set: %s\n", ops->name);
+    BENCH_RUN("AND", ops->and_op(&d, &a, &b));
+    BENCH_RUN("XOR", ops->xor_op(&d, &a, &b));
+    BENCH_RUN("NOT", ops->not_op(&d, &a));
+    BENCH_RUN("SHL 203", reg1220_shl(&d, &a, 203));
+    BENCH_RUN("ROR 777", reg1220_ror(&d, &a, 777));
+    BENCH_RUN("CMP", sink += ops->cmp_op(&a, &b));
+    BENCH_RUN("POPCOUNT", sink += ops->popcount_op(&a));
+    BENCH_RUN("CLZ", sink += ops->clz_op(&a));
+    BENCH_RUN("CTZ", sink += ops->ctz_op(&a));
+    REG1220_OPS = saved;
+}
+
+// Streams the same data set through the same inline XOR-fold from padded Reg1220 memory
+// and straight from packed Mem1220 blocks (bodies plus tails, no per-word unpack copy),
+// so the only difference is the storage layout.
+#define BENCH_MEM_WORDS (1L << 19) // 80 MB padded: well beyond any last-level cache
+#define BENCH_MEM_PASSES 5
+
+void run_memory_benchmark() {
+    Reg1220 *padded = aligned_alloc(CACHE_LINE_BYTES, BENCH_MEM_WORDS * sizeof(Reg1220));
+    Mem1220 packed;
+    Reg1220 acc[2], word;
+    if (padded == NULL || !mem1220_init(&packed, BENCH_MEM_WORDS)) {
+        printf("[BENCH] Not enough host memory for the memory benchmark.\n");
+        free(padded);
+        return;
+    }
+    for (long i = 0; i < BENCH_MEM_WORDS; i++) {
+        for (int j = 0; j < NUM_SEGMENTS; j++) word.seg[j] = 0x9E3779B97F4A7C15ULL * (i * NUM_SEGMENTS + j + 1);
+        word.seg[NUM_SEGMENTS - 1] &= 0xF; // 1220 significant bits
+        padded[i] = word;
+        mem1220_store(&packed, i, &word);
+    }
+
+    // Every word must unpack to exactly what was stored, in all 20 segments
+    long mismatches = 0;
+    for (long i = 0; i < BENCH_MEM_WORDS; i++) {
+        mem1220_load(&word, &packed, i);
+        if (memcmp(&word, &padded[i], sizeof(Reg1220)) != 0) mismatches++;
+    }
+
+    double padded_bytes = (double)BENCH_MEM_WORDS * sizeof(Reg1220);
+    double packed_bytes = (double)BENCH_MEM_WORDS / MEM1220_BLOCK_WORDS * sizeof(Mem1220Block);
+    printf("[BENCH] XOR-fold of %ld words, %d passes (%ld pack/unpack mismatches)\n",
+           BENCH_MEM_WORDS, BENCH_MEM_PASSES, mismatches);
+
+    memset(acc, 0, sizeof(acc));
+    double t0 = now_ns();
+    for (int pass = 0; pass < BENCH_MEM_PASSES; pass++) {
+        for (long i = 0; i < BENCH_MEM_WORDS; i++) {
+            for (int j = 0; j < NUM_SEGMENTS; j++) acc[0].seg[j] ^= padded[i].seg[j];
+        }
+    }
+    double ns = (now_ns() - t0) / BENCH_MEM_PASSES;
+    printf("  padded   %6.1f MB  %7.2f ns/word  %6.2f GB/s\n",
+           padded_bytes / 1e6, ns / BENCH_MEM_WORDS, padded_bytes / ns);
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_MEM_PASSES; pass++) {
+        for (long b = 0; b < BENCH_MEM_WORDS / MEM1220_BLOCK_WORDS; b++) {
+            const Mem1220Block *block = &packed.blocks[b];
+            for (int slot = 0; slot < MEM1220_BLOCK_WORDS; slot++) {
+                for (int j = 0; j < MEM1220_BODY_SEGMENTS; j++) acc[1].seg[j] ^= block->body[slot][j];
+                acc[1].seg[NUM_SEGMENTS - 1] ^= (block->tails[slot / 2] >> ((slot & 1) * 4)) & 0xF;
+            }
+        }
+    }
+    ns = (now_ns() - t0) / BENCH_MEM_PASSES;
+    printf("  packed   %6.1f MB  %7.2f ns/word  %6.2f GB/s (%s)\n",
+           packed_bytes / 1e6, ns / BENCH_MEM_WORDS, packed_bytes / ns,
+           memcmp(&acc[0], &acc[1], sizeof(Reg1220)) == 0 ? "results match" : "RESULT MISMATCH");
+
+    mem1220_free(&packed);
+    free(padded);
+}
+
+int main(int argc, char *argv[]) {
+    reg1220_ops_init();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        run_alu_benchmark(&REG1220_OPS_SCALAR);
+#ifdef SCSA_X86_SIMD
+        if (cpu_supports_set("avx2")) run_alu_benchmark(&REG1220_OPS_AVX2);
+        if (cpu_supports_set("avx512f")) run_alu_benchmark(&REG1220_OPS_AVX512);
+#endif
+        printf("[BENCH] VM uses: %s\n", REG1220_OPS->name);
+        run_memory_benchmark();
+        return 0;
+    }
+
     printf("\n+======================================================+\n");
     printf("| SCSA-1220: THE INFINITE COMPUTE MACHINE              |\n");
     printf("| Address Space: 2^1220 Bytes (Theoretical Infinity)   |\n");
     printf("+======================================================+\n");
 
     // A: PSI/O Phase: Sets the initial 1220-bit state
-    printf("[A: PSI/O] Setting up initial 1220-bit registers...\n");
+    printf("[A: PSI/O] Setting up initial 1220-bit registers (ALU kernels: %s)...\n", REG1220_OPS->name);
     // Initialize low segment to 1 and highest effective segment with the Security Tag
     PC_1220.seg[0] = 0x0000000000000001ULL;
     PC_1220.seg[NUM_SEGMENTS - 1] = SECURITY_TAG_1220; 
@@ -1,18 +1,31 @@
 // file: ~/scsa/src/compiler/scsa-16bit-emulator.c (SCSA-16 Secure Boot VM)
 // UPGRADE: Reads 'bootloader.bin' and activates the PSI/O Shell on failure.
+// UPGRADE: '--aot' translates the bootloader to native code (cached shared object).
+// UPGRADE: '--watch' hot-patches the running VM whenever bootloader.bin is re-assembled.
+// Build: cc -O2 -o scsa-16bit-emulator scsa-16bit-emulator.c -ldl
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <ctype.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <time.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 
 // HARDWARE CONSTANTS
 #define MEMORY_SIZE 0x10000 // 64 Kilobytes
 #define PSIO_BOOT_ADDRESS 0xF000 
 #define BOOTLOADER_MAX_SIZE 0xA000 // 40 KB limit (More realistic for 64KB RAM)
 #define BOOTLOADER_START_ADDR 0x0100 
+#define CYCLE_LIMIT 20
 unsigned char RAM[MEMORY_SIZE]; 
+long BOOTLOADER_SIZE = 0; // Bytes loaded at BOOTLOADER_START_ADDR
+unsigned char LOADED_IMAGE[BOOTLOADER_MAX_SIZE]; // Bootloader bytes as loaded (or last hot-patched)
 
 // Registers (16-bit)
 uint16_t PC = 0;   
@@ -20,6 +33,8 @@ uint8_t IR_OPCODE = 0;
 uint8_t IR_REGISTER = 0; 
 uint16_t IR_OPERAND = 0; 
 uint16_t ACCUMULATOR = 0; 
+int AOT_CODE_WRITTEN = 0; // Set when the interpreter stores into AOT-translated code
+extern unsigned char AOT_CODE[];
 
 // OPCODE MAPPING
 #define OPCODE_HLT 0x0
@@ -56,7 +71,10 @@ void execute_instruction() {
             printf("HLT (00) executed. Simulation stopped.\n");
             pc_increment = 0; return; 
         case OPCODE_LDA: ACCUMULATOR = *(uint16_t*)&RAM[MAR]; break;
-        case OPCODE_STA: *(uint16_t*)&RAM[MAR] = ACCUMULATOR; break;
+        case OPCODE_STA:
+            *(uint16_t*)&RAM[MAR] = ACCUMULATOR;
+            if (AOT_CODE[MAR] | AOT_CODE[MAR + 1]) AOT_CODE_WRITTEN = 1;
+            break;
         case OPCODE_LDI: ACCUMULATOR = MAR; break;
         case OPCODE_ADD: ACCUMULATOR += *(uint16_t*)&RAM[MAR]; break;
         case OPCODE_MUL: ACCUMULATOR *= *(uint16_t*)&RAM[MAR]; break;
@@ -92,6 +110,8 @@ int load_bootloader_file(const char *filename) {
     // Load the file content into RAM starting at BOOTLOADER_START_ADDR (0x0100)
     size_t bytes_read = fread(&RAM[BOOTLOADER_START_ADDR], 1, file_size, file);
     fclose(file);
+    BOOTLOADER_SIZE = (long)bytes_read;
+    memcpy(LOADED_IMAGE, &RAM[BOOTLOADER_START_ADDR], BOOTLOADER_SIZE);
 
     // 6/7. Check Architecture & Source (Simulated via fixed header)
     if (RAM[BOOTLOADER_START_ADDR] >> 4 != OPCODE_LDA || RAM[BOOTLOADER_START_ADDR + 1] != 0x01) {
@@ -103,6 +123,364 @@ int load_bootloader_file(const char *filename) {
     return 1; // Success
 }
 
+// --- PSI/O AOT Translation ---
+// With '--aot', the loaded bootloader is translated to C, compiled to a shared object
+// and cached as <cache>/<hash>-v<version>.so, where <hash> is the FNV-1a hash of the
+// image bytes. Later boots of the same image dlopen the cached object and run natively
+// from the first instruction. Cache: $SCSA_AOT_CACHE, or $HOME/.cache/scsa-aot.
+// Compiler: $CC (a single program name), or cc.
+//
+// The hash only names the cache file. The object embeds the translator version and the
+// full image it was built from, and is used only if both match the loaded image exactly.
+//
+// Self-modifying code is detected at run time, not by static analysis: AOT_CODE marks
+// every byte of a translated instruction, and any store that touches one (from the
+// interpreter or from native code) drops the translation for the rest of the run.
+// Jumps into untranslated code, unknown opcodes and the cycle limit all return control
+// to the interpreter with PC and ACC written back.
+#define AOT_TRANSLATOR_VERSION 2 // Bump on any change to the generated code or AotRunFn
+
+// Native entry point: returns 0 if *pc is not a translated instruction, 1 after running,
+// or AOT_EXIT_SMC after a store into translated code.
+#define AOT_EXIT_SMC 2
+typedef int (*AotRunFn)(unsigned char *ram, uint16_t *pc, uint16_t *acc, int *cycle, int limit);
+AotRunFn AOT_RUN = NULL;
+void *AOT_HANDLE = NULL;
+
+uint64_t fnv1a_hash(const unsigned char *data, size_t len) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+int aot_opcode_supported(uint8_t opcode) {
+    switch (opcode) {
+        case OPCODE_HLT: case OPCODE_LDA: case OPCODE_STA: case OPCODE_LDI:
+        case OPCODE_ADD: case OPCODE_MUL: case OPCODE_JMP:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Marks the instruction addresses of the image that get translated (linear decode from
+// the entry point), and every byte they occupy in 'code_bytes'.
+void aot_find_translatable(unsigned char *translatable, unsigned char *code_bytes,
+                           const unsigned char *image, uint16_t start, long size) {
+    memset(translatable, 0, MEMORY_SIZE);
+    memset(code_bytes, 0, MEMORY_SIZE + 1);
+    for (long off = 0; off + 3 <= size; off += 3) {
+        uint16_t a = start + off;
+        if (aot_opcode_supported(image[off] >> 4)) {
+            translatable[a] = 1;
+            code_bytes[a] = code_bytes[a + 1] = code_bytes[a + 2] = 1;
+        }
+    }
+}
+
+int aot_write_translation(const char *path, uint64_t hash, const unsigned char *image, uint16_t start, long size) {
+    static unsigned char translatable[MEMORY_SIZE], code_bytes[MEMORY_SIZE + 1];
+    FILE *out = fopen(path, "w");
+    if (out == NULL) return 0;
+    aot_find_translatable(translatable, code_bytes, image, start, size);
+
+    fprintf(out, "// SCSA-16 AOT translation of image %016llX (generated, do not edit)\n", (unsigned long long)hash);
+    fprintf(out, "#include <stdint.h>\n#include <string.h>\n\n");
+    fprintf(out, "const int scsa_aot_version = %d;\n", AOT_TRANSLATOR_VERSION);
+    fprintf(out, "const long scsa_aot_image_size = %ld;\n", size);
+    fprintf(out, "const unsigned char scsa_aot_image[] = {");
+    for (long off = 0; off < size; off++) fprintf(out, "%s0x%02X,", (off % 16) ? " " : "\n    ", image[off]);
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "static uint16_t rd16(const unsigned char *ram, uint16_t a) { uint16_t v; memcpy(&v, &ram[a], 2); return v; }\n");
+    fprintf(out, "static void wr16(unsigned char *ram, uint16_t a, uint16_t v) { memcpy(&ram[a], &v, 2); }\n\n");
+    fprintf(out, "#define EXIT_AT(a) do { *pc = (a); goto out; } while (0)\n");
+    fprintf(out, "#define SMC_EXIT_AT(a) do { *pc = (a); rc = %d; goto out; } while (0)\n", AOT_EXIT_SMC);
+    fprintf(out, "#define STEP(a) do { if (cycle >= limit) EXIT_AT(a); cycle++; } while (0)\n\n");
+    fprintf(out, "int scsa_aot_run(unsigned char *ram, uint16_t *pc, uint16_t *acc_io, int *cycle_io, int limit) {\n");
+    fprintf(out, "    uint16_t acc = *acc_io;\n    int cycle = *cycle_io, rc = 1;\n    switch (*pc) {\n");
+    for (long off = 0; off + 3 <= size; off += 3) {
+        uint16_t a = start + off;
+        if (translatable[a]) fprintf(out, "        case 0x%04X: goto L_%04X;\n", a, a);
+    }
+    fprintf(out, "        default: return 0;\n    }\n");
+
+    for (long off = 0; off + 3 <= size; off += 3) {
+        uint16_t a = start + off;
+        if (!translatable[a]) continue;
+        uint8_t opcode = image[off] >> 4;
+        uint16_t mar = (image[off + 1] << 8) | image[off + 2];
+        uint16_t next = (a + 3) % MEMORY_SIZE;
+
+        fprintf(out, "L_%04X: ", a);
+        if (opcode == OPCODE_HLT) { fprintf(out, "EXIT_AT(0x%04X);\n", a); continue; }
+        fprintf(out, "STEP(0x%04X); ", a);
+        switch (opcode) {
+            case OPCODE_LDA: fprintf(out, "acc = rd16(ram, 0x%04X); ", mar); break;
+            case OPCODE_STA:
+                fprintf(out, "wr16(ram, 0x%04X, acc); ", mar);
+                // Store addresses are immediates, so a hit on translated code is known here
+                if (code_bytes[mar] || code_bytes[mar + 1]) { fprintf(out, "SMC_EXIT_AT(0x%04X);\n", next); continue; }
+                break;
+            case OPCODE_LDI: fprintf(out, "acc = 0x%04X; ", mar); break;
+            case OPCODE_ADD: fprintf(out, "acc += rd16(ram, 0x%04X); ", mar); break;
+            case OPCODE_MUL: fprintf(out, "acc *= rd16(ram, 0x%04X); ", mar); break;
+            case OPCODE_JMP: next = mar; break;
+        }
+        if (translatable[next]) fprintf(out, "goto L_%04X;\n", next);
+        else fprintf(out, "EXIT_AT(0x%04X);\n", next);
+    }
+    fprintf(out, "out:\n    *acc_io = acc;\n    *cycle_io = cycle;\n    return rc;\n}\n");
+    return fclose(out) == 0;
+}
+
+void aot_cache_dir(char *dir, size_t len) {
+    const char *env = getenv("SCSA_AOT_CACHE");
+    if (env != NULL && env[0] != '\0') {
+        snprintf(dir, len, "%s", env);
+    } else {
+        const char *home = getenv("HOME");
+        snprintf(dir, len, "%s/.cache", home ? home : ".");
+        mkdir(dir, 0700);
+        snprintf(dir, len, "%s/.cache/scsa-aot", home ? home : ".");
+    }
+    mkdir(dir, 0700); // Cached objects are dlopen'ed: keep the directory private
+}
+
+#define AOT_CACHE_MAX_OBJECTS 32
+
+// Keeps the cache bounded ('--watch --aot' builds one object per edit): removes the
+// least recently used objects beyond AOT_CACHE_MAX_OBJECTS, never 'keep' (the object
+// just built). Only names of the form <hash>-v<version>.so are touched; a cache hit
+// refreshes the object's mtime.
+void aot_cache_evict(const char *dir, const char *keep) {
+    for (;;) {
+        DIR *d = opendir(dir);
+        if (d == NULL) return;
+        char path[320], oldest[320] = "";
+        time_t oldest_mtime = 0;
+        int count = 0;
+        struct dirent *entry;
+        while ((entry = readdir(d)) != NULL) {
+            unsigned long long hash;
+            int version, end = 0;
+            struct stat st;
+            if (sscanf(entry->d_name, "%16llX-v%d.so%n", &hash, &version, &end) != 2 ||
+                end == 0 || entry->d_name[end] != '\0') continue;
+            snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+            if (strcmp(path, keep) == 0 || stat(path, &st) != 0) continue;
+            if (count++ == 0 || st.st_mtime < oldest_mtime) {
+                oldest_mtime = st.st_mtime;
+                snprintf(oldest, sizeof(oldest), "%s", path);
+            }
+        }
+        closedir(d);
+        if (count < AOT_CACHE_MAX_OBJECTS || remove(oldest) != 0) return;
+    }
+}
+
+// Runs the compiler directly (no shell), so cache paths need no quoting.
+int aot_compile(const char *c_path, const char *so_path) {
+    const char *cc = getenv("CC");
+    if (cc == NULL || cc[0] == '\0') cc = "cc";
+    pid_t pid = fork();
+    if (pid < 0) return 0;
+    if (pid == 0) {
+        execlp(cc, cc, "-O2", "-shared", "-fPIC", "-o", so_path, c_path, (char *)NULL);
+        _exit(127);
+    }
+    int status;
+    if (waitpid(pid, &status, 0) < 0) return 0;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Translates and compiles into private temporary files, then publishes the object with
+// rename(), so concurrent boots never see (or compile) a half-written file. The C source
+// is removed; set SCSA_AOT_KEEP_C to keep it next to the object for inspection.
+int aot_build(const char *so_path, uint64_t hash) {
+    char c_tmp[400], so_tmp[400], c_path[400];
+    snprintf(c_tmp, sizeof(c_tmp), "%s.%d.tmp.c", so_path, (int)getpid());
+    snprintf(so_tmp, sizeof(so_tmp), "%s.%d.tmp", so_path, (int)getpid());
+    int ok = aot_write_translation(c_tmp, hash, LOADED_IMAGE, BOOTLOADER_START_ADDR, BOOTLOADER_SIZE) &&
+             aot_compile(c_tmp, so_tmp) &&
+             rename(so_tmp, so_path) == 0;
+    if (ok && getenv("SCSA_AOT_KEEP_C") != NULL) {
+        snprintf(c_path, sizeof(c_path), "%.*s.c", (int)(strlen(so_path) - 3), so_path);
+        rename(c_tmp, c_path);
+    }
+    remove(c_tmp);
+    remove(so_tmp);
+    return ok;
+}
+
+unsigned char AOT_CODE[MEMORY_SIZE + 1]; // Bytes covered by the loaded translation
+
+void aot_unload() {
+    if (AOT_HANDLE != NULL) dlclose(AOT_HANDLE);
+    AOT_HANDLE = NULL;
+    AOT_RUN = NULL;
+    memset(AOT_CODE, 0, sizeof(AOT_CODE));
+    AOT_CODE_WRITTEN = 0;
+}
+
+// Called after a store hit translated code: the native code is stale from now on.
+void aot_invalidate() {
+    printf("[AOT] Store into translated code (PC %04X). Dropping native translation.\n", PC);
+    aot_unload();
+}
+
+// Loads (translating and compiling on a cache miss) the native code for the bootloader.
+int aot_load_bootloader() {
+    static unsigned char translatable[MEMORY_SIZE];
+    char dir[256], so_path[320];
+    uint64_t hash = fnv1a_hash(LOADED_IMAGE, BOOTLOADER_SIZE);
+    aot_cache_dir(dir, sizeof(dir));
+    snprintf(so_path, sizeof(so_path), "%s/%016llX-v%d.so", dir, (unsigned long long)hash, AOT_TRANSLATOR_VERSION);
+
+    struct stat st;
+    if (stat(so_path, &st) != 0) {
+        printf("[AOT] Cache miss for image %016llX. Translating...\n", (unsigned long long)hash);
+        if (!aot_build(so_path, hash)) {
+            printf("[AOT] Translation failed. Falling back to the interpreter.\n");
+            return 0;
+        }
+        aot_cache_evict(dir, so_path);
+    } else {
+        utime(so_path, NULL); // Mark as recently used for aot_cache_evict()
+    }
+
+    aot_unload();
+    AOT_HANDLE = dlopen(so_path, RTLD_NOW | RTLD_LOCAL);
+    if (AOT_HANDLE == NULL) {
+        printf("[AOT] dlopen failed (%s). Falling back to the interpreter.\n", dlerror());
+        return 0;
+    }
+    const int *so_version = dlsym(AOT_HANDLE, "scsa_aot_version");
+    const long *so_size = dlsym(AOT_HANDLE, "scsa_aot_image_size");
+    const unsigned char *so_image = dlsym(AOT_HANDLE, "scsa_aot_image");
+    AOT_RUN = (AotRunFn)dlsym(AOT_HANDLE, "scsa_aot_run");
+    if (so_version == NULL || *so_version != AOT_TRANSLATOR_VERSION || so_size == NULL ||
+        *so_size != BOOTLOADER_SIZE || so_image == NULL || memcmp(so_image, LOADED_IMAGE, BOOTLOADER_SIZE) != 0 ||
+        AOT_RUN == NULL) {
+        printf("[AOT] Cached object does not match image %016llX. Falling back to the interpreter.\n",
+               (unsigned long long)hash);
+        aot_unload();
+        return 0;
+    }
+    aot_find_translatable(translatable, AOT_CODE, LOADED_IMAGE, BOOTLOADER_START_ADDR, BOOTLOADER_SIZE);
+    printf("[AOT] Native translation loaded: %s\n", so_path);
+    return 1;
+}
+
+// Nonzero when RAM still holds LOADED_IMAGE over every byte a translation of it would
+// cover, i.e. the guest has not rewritten any of that code since it was loaded.
+int aot_ram_matches_image() {
+    static unsigned char translatable[MEMORY_SIZE], code_bytes[MEMORY_SIZE + 1];
+    aot_find_translatable(translatable, code_bytes, LOADED_IMAGE, BOOTLOADER_START_ADDR, BOOTLOADER_SIZE);
+    for (long off = 0; off < BOOTLOADER_SIZE; off++) {
+        uint16_t a = BOOTLOADER_START_ADDR + off;
+        if (code_bytes[a] && RAM[a] != LOADED_IMAGE[off]) return 0;
+    }
+    return 1;
+}
+
+int AOT_ENABLED = 0; // Set by '--aot'
+
+// --- PSI/O Hot Patching ---
+// With '--watch', the VM keeps running and polls bootloader.bin (run 'assembler --watch'
+// next to it). A changed image goes through the same Secure Boot checks, is diffed
+// byte-by-byte against LOADED_IMAGE, and only the differing bytes are written to RAM.
+// Patches are applied between instructions, so the guest never sees a half-patched
+// instruction. Bytes the guest itself wrote are left alone unless the image changed them.
+// Any patch drops the native translation. '--aot' reloads one for the new image only if
+// RAM matches that image over every translated byte; if the guest rewrote its own code,
+// it stays interpreted until the next restart.
+// A running guest continues from its current PC. A halted or stalled guest has nothing
+// left to run, so a patch restarts it: RAM is cleared (except the PSI/O ROM) and the image
+// reloaded, and execution begins again at BOOTLOADER_START_ADDR with ACC cleared, exactly
+// as on a fresh boot.
+#define WATCH_POLL_CYCLES 4096 // Instructions between checks of bootloader.bin
+#define WATCH_IDLE_US 20000    // Poll interval while the guest is halted (20 ms)
+
+int WATCH_ENABLED = 0; // Set by '--watch'
+
+void psio_restart_guest() {
+    unsigned char rom[3]; // PSI/O JMP written by load_psio_firmware()
+    memcpy(rom, &RAM[PSIO_BOOT_ADDRESS], sizeof(rom));
+    memset(RAM, 0, MEMORY_SIZE);
+    memcpy(&RAM[PSIO_BOOT_ADDRESS], rom, sizeof(rom));
+    memcpy(&RAM[BOOTLOADER_START_ADDR], LOADED_IMAGE, BOOTLOADER_SIZE);
+    PC = BOOTLOADER_START_ADDR;
+    ACCUMULATOR = 0;
+    if (AOT_ENABLED && AOT_RUN == NULL) aot_load_bootloader(); // Dropped by a store into code
+    printf("[WATCH] Restarting guest at 0x%04X.\n", PC);
+}
+struct timespec WATCH_MTIME;
+off_t WATCH_SIZE = -1;
+
+int bootloader_changed(const char *filename) {
+    struct stat st;
+    if (stat(filename, &st) != 0) return 0;
+    if (st.st_mtim.tv_sec == WATCH_MTIME.tv_sec && st.st_mtim.tv_nsec == WATCH_MTIME.tv_nsec &&
+        st.st_size == WATCH_SIZE) return 0;
+    WATCH_MTIME = st.st_mtim;
+    WATCH_SIZE = st.st_size;
+    return 1;
+}
+
+// Returns the number of bytes patched into RAM (0 if unchanged or rejected).
+int psio_hot_patch(const char *filename) {
+    static unsigned char image[BOOTLOADER_MAX_SIZE];
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) return 0;
+    long size = (long)fread(image, 1, BOOTLOADER_MAX_SIZE, file);
+    int too_big = (fgetc(file) != EOF);
+    fclose(file);
+    if (size == 0 || too_big) {
+        printf("[WATCH] Security Check FAILED: New bootloader size is invalid. Patch rejected.\n");
+        return 0;
+    }
+    if (image[0] >> 4 != OPCODE_LDA || image[1] != 0x01) {
+        printf("[WATCH] Security Check FAILED: Bootloader signature not found. Patch rejected.\n");
+        return 0;
+    }
+
+    long span = (size > BOOTLOADER_SIZE) ? size : BOOTLOADER_SIZE;
+    int patched = 0, range_start = -1;
+    for (long off = 0; off <= span; off++) {
+        unsigned char old_byte = (off < BOOTLOADER_SIZE) ? LOADED_IMAGE[off] : 0;
+        unsigned char new_byte = (off < size) ? image[off] : 0;
+        if (off < span && old_byte != new_byte) {
+            RAM[BOOTLOADER_START_ADDR + off] = new_byte;
+            patched++;
+            if (range_start < 0) range_start = (int)off;
+        } else if (range_start >= 0) {
+            printf("[WATCH] Patched 0x%04X-0x%04X\n", BOOTLOADER_START_ADDR + range_start,
+                   (unsigned)(BOOTLOADER_START_ADDR + off - 1));
+            range_start = -1;
+        }
+    }
+    memcpy(LOADED_IMAGE, image, size);
+    BOOTLOADER_SIZE = size;
+    if (patched == 0) return 0;
+
+    // The translation covers the whole image, so any patch invalidates it
+    if (AOT_RUN != NULL || AOT_ENABLED) {
+        aot_unload();
+        if (AOT_ENABLED && aot_ram_matches_image()) aot_load_bootloader();
+        else if (AOT_ENABLED) printf("[AOT] Guest has rewritten its code. Interpreting until the next restart.\n");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("[WATCH] %d bytes patched at PC %04X in %.2f ms.\n", patched, PC,
+           (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6);
+    return patched;
+}
+
 void load_psio_firmware() {
     printf("Loading PSI/O Firmware at fixed address 0x%04X...\n", PSIO_BOOT_ADDRESS);
     
@@ -116,6 +494,7 @@ void load_psio_firmware() {
     if (load_bootloader_file("bootloader.bin")) {
         // 5. Enable Secure Boot (Conceptual: No action needed as JMP is already written)
         PC = PSIO_BOOT_ADDRESS; // Start PC at the PSI/O jump point
+        if (AOT_ENABLED) aot_load_bootloader();
     } else {
         // Failure: HLT the fixed boot address to prevent running faulty JMP
         RAM[PSIO_BOOT_ADDRESS + 0] = 0x00; 
@@ -123,10 +502,16 @@ void load_psio_firmware() {
     }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--aot") == 0) AOT_ENABLED = 1;
+        if (strcmp(argv[i], "--watch") == 0) WATCH_ENABLED = 1;
+    }
+
     // Clear RAM
     memset(RAM, 0, MEMORY_SIZE); 
     
+    if (WATCH_ENABLED) bootloader_changed("bootloader.bin"); // Record the booted version
     load_psio_firmware();
     
     printf("\n+==========================================+\n");
@@ -142,21 +527,57 @@ int main() {
         return 0;
     }
 
-    while (RAM[PC] >> 4 != OPCODE_HLT && cycle < 20) { 
-        // 1. FETCH
-        IR_OPCODE = (RAM[PC] >> 4) & 0xF; 
-        IR_REGISTER = RAM[PC] & 0xF; 
-        IR_OPERAND = (RAM[PC+1] << 8) | RAM[PC+2]; 
+    // In watch mode the cycle limit is a time slice: after each slice (or while the guest
+    // is halted or stalled) bootloader.bin is checked for changes and execution resumes.
+    int cycle_limit = WATCH_ENABLED ? WATCH_POLL_CYCLES : CYCLE_LIMIT;
+    int stalled = 0;
+    while (1) {
+        while (RAM[PC] >> 4 != OPCODE_HLT && cycle < cycle_limit && !stalled) { 
+            // 0. NATIVE: run translated code until it exits back to the interpreter
+            if (AOT_RUN != NULL) {
+                int rc = AOT_RUN(RAM, &PC, &ACCUMULATOR, &cycle, cycle_limit);
+                if (rc == AOT_EXIT_SMC) aot_invalidate();
+                if (rc) continue;
+            }
+
+            // 1. FETCH
+            IR_OPCODE = (RAM[PC] >> 4) & 0xF; 
+            IR_REGISTER = RAM[PC] & 0xF; 
+            IR_OPERAND = (RAM[PC+1] << 8) | RAM[PC+2]; 
+
+            // 2. State Print
+            if (WATCH_ENABLED) cycle++;
+            else print_state(cycle++);
+            
+            // 3. EXECUTE 
+            uint16_t pc_before = PC;
+            execute_instruction();
+            if (AOT_CODE_WRITTEN) aot_invalidate();
+            stalled = WATCH_ENABLED && PC == pc_before && IR_OPCODE != OPCODE_JMP; // Unknown opcode
+        }
+        if (!WATCH_ENABLED) break;
 
-        // 2. State Print
-        print_state(cycle++);
-        
-        // 3. EXECUTE 
-        execute_instruction();
+        int waiting = (RAM[PC] >> 4 == OPCODE_HLT) || stalled;
+        if (waiting) {
+            printf("[WATCH] Guest %s at PC %04X. RAM[FFFE]: %d (0x%04X). Waiting for changes...\n",
+                   stalled ? "stalled" : "halted", PC, *(uint16_t*)&RAM[0xFFFE], *(uint16_t*)&RAM[0xFFFE]);
+            fflush(stdout);
+        }
+        do {
+            if (waiting) usleep(WATCH_IDLE_US);
+            if (bootloader_changed("bootloader.bin") && psio_hot_patch("bootloader.bin")) {
+                if (waiting) psio_restart_guest();
+                break;
+            }
+        } while (waiting);
+        fflush(stdout);
+        cycle = 0;
+        stalled = 0;
     }
     
     printf("\n--- VM Execution Complete ---\n");
     printf("Final Result (RAM[FFFE]): %d (0x%04X)\n", *(uint16_t*)&RAM[0xFFFE], *(uint16_t*)&RAM[0xFFFE]);
     
+    aot_unload();
     return 0;
 }
@@ -1,12 +1,18 @@
 // file: ~/scsa/src/compiler/scsa-8bit-emulator.c (SCSA-8 AI Ready VM)
 // -----------------------------------------------------------------
 // SCSA-8 UPGRADE: Added MUL and DIV instructions for basic AI operations.
+// SCSA-8 UPGRADE: IN/OUT ports are now streaming ports backed by host files/pipes.
 // -----------------------------------------------------------------
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // HARDWARE CONSTANTS (8-Bit Upgrade)
 #define MEMORY_SIZE 256 
@@ -16,6 +22,11 @@ unsigned char IR_OPCODE = 0;
 unsigned char IR_OPERAND = 0; 
 unsigned char ACCUMULATOR = 0; 
 unsigned char I_O_PORT = 0xFF; 
+int TRACE_ENABLED = 1; // Per-cycle state printing (disabled in streaming mode)
+
+#define TRACE(...) do { if (TRACE_ENABLED) printf(__VA_ARGS__); } while (0)
+// Errors are always reported: on stdout while tracing, on stderr in streaming mode.
+#define TRACE_ERROR(...) do { if (TRACE_ENABLED) printf(__VA_ARGS__); else fprintf(stderr, __VA_ARGS__); } while (0)
 
 // OPCODE MAPPING (SCSA-8 AI ISA)
 #define OPCODE_HLT 0x0
@@ -26,10 +37,129 @@ unsigned char I_O_PORT = 0xFF;
 #define OPCODE_SUB 0xD 
 #define OPCODE_MUL 0xE // NEW: Multiply Instruction
 #define OPCODE_DIV 0xF // NEW: Divide Instruction
-// (JMP, JNZ, IN, OUT, NOT, XOR, AND are assumed to be 0x5 to 0xB)
+#define OPCODE_JMP 0x8
+#define OPCODE_JNZ 0x9
+#define OPCODE_IN  0xA // Streaming Input Port (operand = end-of-stream jump target)
+#define OPCODE_OUT 0xB // Streaming Output Port
+// (NOT, XOR, AND are assumed to be 0x5 to 0x7)
+
+// --- STREAMING I/O PORTS ---
+// The IN port reads from a host file or pipe. Regular files are mmap'd and read in place
+// (zero-copy); pipes are refilled in IO_BATCH_SIZE chunks with a single read().
+// The OUT port collects bytes in a buffer that is drained with a single write() per batch.
+// End of stream is signalled out of band: 'IN ADDR' jumps to ADDR (ACC unchanged) when the
+// port is exhausted or unattached, so every byte value, including 0, is valid stream data.
+#define IO_BATCH_SIZE 0x10000 // 64 KB per host read()/write()
+
+typedef struct {
+    int fd;               // Host file descriptor (-1 = unattached)
+    unsigned char *data;  // mmap'd file or batch buffer
+    size_t head;          // Next byte to consume / first pending byte
+    size_t tail;          // End of valid data
+    size_t capacity;      // Size of 'data'
+    int mapped;           // 1 if 'data' is an mmap of the input file
+} IOPort;
+
+IOPort IN_PORT = { -1, NULL, 0, 0, 0, 0 };
+IOPort OUT_PORT = { -1, NULL, 0, 0, 0, 0 };
+int IO_ERROR = 0; // Set on any host read/write failure: the stream was not fully copied
+
+int attach_input_port(const char *path) {
+    int fd = (strcmp(path, "-") == 0) ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("[IO] Cannot open input port source");
+        return 0;
+    }
+    IN_PORT.fd = fd;
+
+    // Regular file: map it once and let IN read straight from the page cache.
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            IN_PORT.data = map;
+            IN_PORT.capacity = IN_PORT.tail = st.st_size;
+            IN_PORT.mapped = 1;
+            return 1;
+        }
+    }
+
+    // Pipe/terminal (or mmap failure): fall back to batched reads.
+    IN_PORT.data = malloc(IO_BATCH_SIZE);
+    if (IN_PORT.data == NULL) return 0;
+    IN_PORT.capacity = IO_BATCH_SIZE;
+    return 1;
+}
+
+int attach_output_port(const char *path) {
+    int fd = (strcmp(path, "-") == 0) ? STDOUT_FILENO : open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("[IO] Cannot open output port sink");
+        return 0;
+    }
+    OUT_PORT.fd = fd;
+    OUT_PORT.data = malloc(IO_BATCH_SIZE);
+    if (OUT_PORT.data == NULL) return 0;
+    OUT_PORT.capacity = IO_BATCH_SIZE;
+    return 1;
+}
+
+// Returns 1 and stores the next byte in *value, or 0 at end of stream.
+// After any I/O error the stream also ends, so the guest reaches its EOF path and halts.
+int io_port_in(unsigned char *value) {
+    if (IO_ERROR) return 0;
+    if (IN_PORT.head == IN_PORT.tail) {
+        if (IN_PORT.fd < 0 || IN_PORT.mapped) return 0; // End of stream
+        ssize_t n;
+        do {
+            n = read(IN_PORT.fd, IN_PORT.data, IN_PORT.capacity);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) { perror("[IO] Input port read failed"); IO_ERROR = 1; }
+        if (n <= 0) return 0;
+        IN_PORT.head = 0;
+        IN_PORT.tail = (size_t)n;
+    }
+    *value = IN_PORT.data[IN_PORT.head++];
+    return 1;
+}
+
+void io_port_flush() {
+    while (OUT_PORT.head < OUT_PORT.tail) {
+        ssize_t n = write(OUT_PORT.fd, OUT_PORT.data + OUT_PORT.head, OUT_PORT.tail - OUT_PORT.head);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) { perror("[IO] Output port write failed"); IO_ERROR = 1; break; }
+        OUT_PORT.head += (size_t)n;
+    }
+    OUT_PORT.head = OUT_PORT.tail = 0;
+}
+
+void io_port_out(unsigned char value) {
+    RAM[I_O_PORT] = value; // Legacy view: last value written is visible at RAM[FF]
+    if (OUT_PORT.fd < 0 || IO_ERROR) return;
+    OUT_PORT.data[OUT_PORT.tail++] = value;
+    if (OUT_PORT.tail == OUT_PORT.capacity) io_port_flush();
+}
+
+void detach_io_ports() {
+    if (OUT_PORT.fd >= 0) {
+        if (!IO_ERROR) io_port_flush();
+        if (OUT_PORT.fd != STDOUT_FILENO && close(OUT_PORT.fd) != 0) {
+            perror("[IO] Output port close failed");
+            IO_ERROR = 1;
+        }
+        free(OUT_PORT.data);
+    }
+    if (IN_PORT.fd >= 0) {
+        if (IN_PORT.mapped) munmap(IN_PORT.data, IN_PORT.capacity);
+        else free(IN_PORT.data);
+        if (IN_PORT.fd != STDIN_FILENO) close(IN_PORT.fd);
+    }
+}
 
 // Function to print CPU state
 void print_state(int cycle) {
+    if (!TRACE_ENABLED) return;
     printf("--- CYCLE %d ---\n", cycle);
     printf("PC: %02X | Opcode: %01X | Operand: %02X | ACC: %02X (%d) | RAM[FF]: %02X\n",
            PC, IR_OPCODE, IR_OPERAND, ACCUMULATOR, ACCUMULATOR, RAM[0xFF]); 
@@ -43,51 +173,65 @@ void execute_instruction() {
 
     switch (IR_OPCODE) {
         case OPCODE_HLT: 
-            printf("HLT (00) executed. Simulation stopped.\n");
+            TRACE("HLT (00) executed. Simulation stopped.\n");
             pc_increment = 0; return; 
         case OPCODE_LDA: 
             ACCUMULATOR = RAM[MAR]; 
-            printf("LDA %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
+            TRACE("LDA %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
         case OPCODE_STA: 
             RAM[MAR] = ACCUMULATOR;
-            printf("STA %02X executed. RAM[%02X] set to %02X.\n", MAR, MAR, ACCUMULATOR); break;
+            TRACE("STA %02X executed. RAM[%02X] set to %02X.\n", MAR, MAR, ACCUMULATOR); break;
         case OPCODE_ADD: 
             ACCUMULATOR += RAM[MAR]; 
-            printf("ADD %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
+            TRACE("ADD %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
         case OPCODE_SUB: 
             ACCUMULATOR -= RAM[MAR]; 
-            printf("SUB %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
+            TRACE("SUB %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR); break;
             
         case OPCODE_MUL: // NEW: Multiplication
             temp_result = (unsigned int)ACCUMULATOR * RAM[MAR];
             ACCUMULATOR = (unsigned char)temp_result; // Store 8 bits (Truncate result)
-            printf("MUL %02X executed. ACC = %02X (Result: %u).\n", MAR, ACCUMULATOR, temp_result); break;
+            TRACE("MUL %02X executed. ACC = %02X (Result: %u).\n", MAR, ACCUMULATOR, temp_result); break;
 
         case OPCODE_DIV: // NEW: Division
             if (RAM[MAR] != 0) {
                 ACCUMULATOR /= RAM[MAR]; // Integer division
-                printf("DIV %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR);
+                TRACE("DIV %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR);
             } else {
-                printf("DIVIDE BY ZERO error. Halting.\n");
+                TRACE_ERROR("DIVIDE BY ZERO error. Halting.\n");
                 pc_increment = 0; return;
             }
             break;
         
-        // JMP, JNZ, IN, OUT, etc. cases remain the same (Not repeated here for brevity)
-        case 0x8: // JMP
-        case 0x9: // JNZ
-        case 0xA: // IN
-        case 0xB: // OUT
+        case OPCODE_JMP:
+            PC = MAR; pc_increment = 0;
+            TRACE("JMP %02X executed.\n", MAR); break;
+        case OPCODE_JNZ:
+            if (ACCUMULATOR != 0) { PC = MAR; pc_increment = 0; }
+            TRACE("JNZ %02X executed. %s.\n", MAR, ACCUMULATOR ? "Taken" : "Not taken"); break;
+        case OPCODE_IN:
+            if (io_port_in(&ACCUMULATOR)) {
+                TRACE("IN %02X executed. ACC = %02X.\n", MAR, ACCUMULATOR);
+            } else {
+                PC = MAR; pc_increment = 0; // End of stream
+                TRACE("IN %02X executed. End of stream.\n", MAR);
+            }
+            break;
+        case OPCODE_OUT:
+            io_port_out(ACCUMULATOR);
+            TRACE("OUT executed. PORT = %02X.\n", ACCUMULATOR); break;
+
+        // LDI, NOT, XOR, AND remain conceptual (Not repeated here for brevity)
         case 0x4: // LDI
         case 0x5: // NOT
         case 0x6: // XOR
         case 0x7: // AND
-            printf("--- Non-Arithmetic Opcode (0x%X) executed ---\n", IR_OPCODE);
+            TRACE("--- Non-Arithmetic Opcode (0x%X) executed ---\n", IR_OPCODE);
             // In a full implementation, the logic for these must be placed here.
             break;
 
         default:
-            printf("Unknown Opcode %01X at PC %02X. Halting.\n", IR_OPCODE, PC);
+            TRACE_ERROR("Unknown Opcode %01X at PC %02X. Halting.\n", IR_OPCODE, PC);
             pc_increment = 0;
             return;
     }
@@ -136,16 +280,46 @@ void load_ai_sample_program() {
     PC = 0x00; 
 }
 
-int main() {
-    load_ai_sample_program();
-    
-    printf("\n+==========================================+\n");
-    printf("| SCSA-8 AI Core VM (8-Bit) Execution      |\n");
-    printf("| Program: Weighted Sum (5*10 + 2*4 = 58)  |\n");
-    printf("+==========================================+\n");
+// Streaming Sample Program: Copy the IN port to the OUT port until end of stream
+void load_stream_sample_program() {
+    // 0x00: IN 0x06   (ACC = next input byte, or jump to 0x06 at end of stream)
+    RAM[0x00] = 0xA0; RAM[0x01] = 0x06; 
+
+    // 0x02: OUT       (Output port = ACC)
+    RAM[0x02] = 0xB0; RAM[0x03] = 0x00; 
+
+    // 0x04: JMP 0x00  (Next byte)
+    RAM[0x04] = 0x80; RAM[0x05] = 0x00; 
+
+    // 0x06: HLT       (End of stream)
+    RAM[0x06] = 0x00; RAM[0x07] = 0x00; 
+
+    PC = 0x00; 
+}
+
+int main(int argc, char *argv[]) {
+    // Usage: scsa-8bit-emulator [<input|-> [<output|->]]
+    // With no arguments the AI sample program runs with full tracing.
+    int streaming = (argc > 1);
+    long cycle_limit = 15;
+
+    if (streaming) {
+        if (!attach_input_port(argv[1])) return 1;
+        if (!attach_output_port(argc > 2 ? argv[2] : "-")) return 1;
+        TRACE_ENABLED = 0;
+        cycle_limit = -1; // Run until the guest halts
+        load_stream_sample_program();
+    } else {
+        load_ai_sample_program();
+        
+        printf("\n+==========================================+\n");
+        printf("| SCSA-8 AI Core VM (8-Bit) Execution      |\n");
+        printf("| Program: Weighted Sum (5*10 + 2*4 = 58)  |\n");
+        printf("+==========================================+\n");
+    }
     
-    int cycle = 0;
-    while (RAM[PC] >> 4 != OPCODE_HLT && cycle < 15) { 
+    long cycle = 0;
+    while (RAM[PC] >> 4 != OPCODE_HLT && (cycle_limit < 0 || cycle < cycle_limit)) { 
         IR_OPCODE = (RAM[PC] >> 4) & 0xF; 
         IR_OPERAND = RAM[PC+1];
 
@@ -153,6 +327,16 @@ int main() {
         execute_instruction();
     }
     
+    if (streaming) {
+        detach_io_ports();
+        if (IO_ERROR) {
+            fprintf(stderr, "[IO] Stream aborted after %ld cycles: host I/O error.\n", cycle);
+            return 1;
+        }
+        fprintf(stderr, "[IO] Stream complete after %ld cycles.\n", cycle);
+        return 0;
+    }
+
     printf("\n--- VM Execution Complete ---\n");
     printf("Final Weighted Sum (RAM[FF]): %d (0x%02X)\n", RAM[0xFF], RAM[0xFF]);
     